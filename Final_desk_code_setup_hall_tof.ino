@@ -7,6 +7,8 @@
 #include "motor_control.h"
 #include "web_interface.h"
 #include "storage.h"
+#include "programs.h"
+#include "status_broadcast.h"
 
 // Global state
 bool isMoving = false;
@@ -17,6 +19,10 @@ int lastStoppedPulses = 0;
 unsigned long lastMotorStopTime = 0;
 bool backlightOn = true;
 
+// Error counters (reported in the status record)
+uint16_t moveTimeoutCount = 0;
+uint16_t tofErrorCount = 0;
+
 // I²C devices
 VL53L0X tof;
 LiquidCrystal_I2C lcd(0x27, 16, 2);
@@ -47,6 +53,9 @@ void setup() {
   // Load saved position
   loadPulseCount();
 
+  // Load stored move programs
+  loadPrograms();
+
   // Initialize motor control
   initMotorControl();
   
@@ -75,6 +84,9 @@ void setup() {
 
   // Initialize web server
   initWebServer();
+
+  // Start fleet status broadcast
+  initStatusBroadcast();
 }
 
 void loop() {
@@ -84,6 +96,12 @@ void loop() {
   // Check Hall sensors on every loop
   checkHallSensors();
 
+  // Advance any running move program
+  handlePrograms();
+
+  // Periodic status multicast
+  handleStatusBroadcast();
+
   // LCD backlight timeout control
   if (backlightOn && !isMoving && lastMotorStopTime > 0) {
     if (millis() - lastMotorStopTime > BACKLIGHT_TIMEOUT) {
@@ -135,6 +153,7 @@ void loop() {
       
       if (pulseDifference <= ERROR_THRESHOLD || millis() - moveStartTime > MOVEMENT_TIMEOUT) {
         // Stop when within ERROR_THRESHOLD pulses of target or timeout
+        if (pulseDifference > ERROR_THRESHOLD) moveTimeoutCount++;
         stopDeskMotor();
         isMoving = false;
         
@@ -205,5 +224,7 @@ void calibrateWithTof() {
     Serial.print(" (Height: ");
     Serial.print(measuredHeight);
     Serial.println(" cm)");
+  } else {
+    tofErrorCount++;
   }
 }
\ No newline at end of file
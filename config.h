@@ -8,6 +8,7 @@
 #include <WiFi.h>
 #include <ESPmDNS.h>
 #include <WebServer.h>
+#include <WiFiUdp.h>
 #include <Wire.h>
 #include <LiquidCrystal_I2C.h>
 #include <EEPROM.h>
@@ -42,11 +43,23 @@ const float MIN_HEIGHT_CM = 69.0;       // Height at lowest position
 const float MAX_HEIGHT_CM = 105.0;      // Height at highest position
 const float CM_PER_PULSE = (MAX_HEIGHT_CM - MIN_HEIGHT_CM) / (PULSES_AT_MAX_HEIGHT - PULSES_AT_MIN_HEIGHT);
 
+// — Move programs (sit/stand routines) —
+const uint8_t PROGRAM_SLOTS = 4;         // Programs stored on the device
+const uint8_t PROGRAM_MAX_STEPS = 16;    // Steps per program
+const int PROGRAM_STEP_BYTES = 8;        // type, reserved, height (mm), delay (s) or time of day (s)
+const int PROGRAM_BYTES = 4 + PROGRAM_MAX_STEPS * PROGRAM_STEP_BYTES;
+const unsigned long PROGRAM_MAX_DELAY = 86400;  // Longest delay step: 24 hours
+const unsigned long PROGRAM_MIN_MOVE_INTERVAL = 60;  // Seconds between program moves (flash wear)
+
 // — EEPROM Storage —
-const int EEPROM_SIZE = 16;             // Size to allocate in EEPROM
 const int EEPROM_MAGIC_ADDR = 0;        // Address for magic number (to check if initialized)
 const int EEPROM_PULSES_ADDR = 4;       // Address for pulse count storage
+const int EEPROM_PROGRAMS_MAGIC_ADDR = 8;   // Address for program area magic number
+const int EEPROM_RUNNER_ADDR = 12;      // Running program slot + 1 (0 = none), restarted at boot
+const int EEPROM_PROGRAMS_ADDR = 16;    // Start of program slots
+const int EEPROM_SIZE = EEPROM_PROGRAMS_ADDR + PROGRAM_SLOTS * PROGRAM_BYTES;  // Size to allocate in EEPROM
 const int EEPROM_MAGIC = 0x4445534B;    // "DESK" magic number to verify EEPROM is initialized
+const int EEPROM_PROGRAMS_MAGIC = 0x50524F47;  // "PROG" magic number for the program area
 
 // — PWM / ramp settings —
 const uint8_t  TARGET_SPEED = 249;
@@ -61,6 +74,26 @@ const uint8_t  ERROR_THRESHOLD = 10;
 const unsigned long BACKLIGHT_TIMEOUT = 10000;  // 10 seconds
 const unsigned long MOVEMENT_TIMEOUT = 15000;   // 15 seconds max movement time
 
+// — HTTP server settings —
+const uint16_t HTTP_PORT = 80;
+const uint8_t  HTTP_MAX_CLIENTS = 4;             // Simultaneous persistent connections
+const size_t   HTTP_REQUEST_BUFFER = 1024;       // Per-connection buffer (headers + body)
+const uint8_t  HTTP_MAX_ROUTES = 20;
+const uint8_t  HTTP_MAX_ARGS = 8;
+const unsigned long HTTP_IDLE_TIMEOUT = 5000;    // Close idle keep-alive connections after 5 seconds
+const unsigned long HTTP_REQUEST_TIMEOUT = 2000; // Time allowed to send a complete request
+
+// — Fleet status broadcast —
+const uint8_t  STATUS_MULTICAST_IP[4] = {239, 255, 77, 77};
+const uint16_t STATUS_MULTICAST_PORT = 47077;
+const unsigned long STATUS_BROADCAST_INTERVAL = 1000;        // Idle broadcast period
+const unsigned long STATUS_BROADCAST_MOVING_INTERVAL = 250;  // Broadcast period while moving
+
+// — Time sync (for time-of-day program steps) —
+const cstr NTP_SERVER = "pool.ntp.org";
+const cstr TIME_ZONE  = "UTC0";                  // POSIX TZ string, e.g. "CET-1CEST,M3.5.0,M10.5.0/3"
+const time_t CLOCK_VALID_AFTER = 1577836800;     // 2020-01-01; earlier means NTP has not synced yet
+
 // Direction enum
 enum { DIR_NONE=0, DIR_UP=1, DIR_DOWN=-1 };
 
@@ -76,6 +109,8 @@ extern VL53L0X tof;
 extern LiquidCrystal_I2C lcd;
 extern unsigned long lastMotorStopTime;
 extern bool backlightOn;
+extern uint16_t moveTimeoutCount;
+extern uint16_t tofErrorCount;
 
 // Function declarations for cross-module use
 extern void stopDeskMotor();
@@ -0,0 +1,436 @@
+// http_server.h
+// Non-blocking HTTP/1.1 server with keep-alive and pipelined requests
+
+#ifndef HTTP_SERVER_H
+#define HTTP_SERVER_H
+
+#include <errno.h>
+#include <lwip/sockets.h>
+#include "config.h"
+
+// Route handler, same shape as the WebServer library handlers
+typedef void (*HttpHandler)();
+
+// Serves up to HTTP_MAX_CLIENTS connections from the main loop. Each call
+// to handleClient() reads whatever bytes are waiting and answers at most one
+// buffered request per connection. Responses are queued per connection and
+// written without blocking, so a slow reader never stalls the loop.
+class DeskHttpServer {
+public:
+  DeskHttpServer(uint16_t port) : listener(port) {}
+
+  void on(const char* uri, HttpHandler handler) {
+    on(uri, HTTP_ANY, handler);
+  }
+
+  void on(const char* uri, HTTPMethod method, HttpHandler handler) {
+    if (routeCount >= HTTP_MAX_ROUTES) {
+      Serial.println("HTTP route table full, ignoring " + String(uri));
+      return;
+    }
+    routes[routeCount].uri = uri;
+    routes[routeCount].method = method;
+    routes[routeCount].handler = handler;
+    routeCount++;
+  }
+
+  void begin() {
+    listener.begin();
+    listener.setNoDelay(true);
+  }
+
+  // Service all connections once
+  void handleClient() {
+    acceptClients();
+    for (uint8_t i = 0; i < HTTP_MAX_CLIENTS; i++) {
+      serviceSlot(slots[i]);
+    }
+  }
+
+  // — Request accessors (valid inside a route handler) —
+  bool hasArg(const String& name) const {
+    for (uint8_t i = 0; i < argCount; i++) {
+      if (argNames[i] == name) return true;
+    }
+    return false;
+  }
+
+  String arg(const String& name) const {
+    for (uint8_t i = 0; i < argCount; i++) {
+      if (argNames[i] == name) return argValues[i];
+    }
+    return "";
+  }
+
+  // — Response (valid inside a route handler) —
+  void sendHeader(const String& name, const String& value) {
+    extraHeaders += name + ": " + value + "\r\n";
+  }
+
+  void send(int code, const char* contentType, const String& content) {
+    send(code, contentType, (const uint8_t*)content.c_str(), content.length());
+  }
+
+  // Binary body (may contain NUL bytes)
+  void send(int code, const char* contentType, const uint8_t* content, size_t length) {
+    if (current == nullptr || responded) return;
+    responded = true;
+
+    String head = "HTTP/1.1 " + String(code) + " " + statusText(code) + "\r\n";
+    head += "Content-Type: " + String(contentType) + "\r\n";
+    head += "Content-Length: " + String(length) + "\r\n";
+    head += extraHeaders;
+    head += keepAlive ? "Connection: keep-alive\r\n" : "Connection: close\r\n";
+    head += "\r\n";
+
+    // Queue the response; serviceSlot() writes it out over the next ticks
+    current->out = head;
+    current->out.concat((const char*)content, length);
+    current->outPos = 0;
+  }
+
+  // Connections and requests refused (busy, oversized or malformed)
+  uint16_t rejectedCount() const {
+    return rejected;
+  }
+
+private:
+  struct Route {
+    const char* uri;
+    HTTPMethod method;
+    HttpHandler handler;
+  };
+
+  struct Slot {
+    bool active = false;
+    WiFiClient client;
+    char buf[HTTP_REQUEST_BUFFER + 1];  // +1 for terminator
+    size_t len = 0;
+    String out;                    // Queued response
+    size_t outPos = 0;             // Bytes of out already written
+    bool closeAfterFlush = false;  // Close once out is written
+    bool served = false;           // At least one request answered
+    unsigned long requestStart = 0;  // When the request being received began
+    unsigned long lastActivity = 0;
+  };
+
+  WiFiServer listener;
+  Route routes[HTTP_MAX_ROUTES];
+  uint8_t routeCount = 0;
+  Slot slots[HTTP_MAX_CLIENTS];
+  uint16_t rejected = 0;
+
+  // Per-request state
+  Slot* current = nullptr;
+  bool keepAlive = true;
+  bool responded = false;
+  String extraHeaders;
+  String argNames[HTTP_MAX_ARGS];
+  String argValues[HTTP_MAX_ARGS];
+  uint8_t argCount = 0;
+
+  static const char* statusText(int code) {
+    switch (code) {
+      case 200: return "OK";
+      case 302: return "Found";
+      case 400: return "Bad Request";
+      case 401: return "Unauthorized";
+      case 404: return "Not Found";
+      case 413: return "Payload Too Large";
+      case 431: return "Request Header Fields Too Large";
+      case 501: return "Not Implemented";
+      case 503: return "Service Unavailable";
+      default:  return "Internal Server Error";
+    }
+  }
+
+  // Take new connections into free slots. When all are taken, the least
+  // recently used idle keep-alive slot makes room; only if every slot is
+  // mid-request does the newcomer get 503.
+  void acceptClients() {
+    if (!listener.hasClient()) return;
+
+    Slot* target = nullptr;
+    for (uint8_t i = 0; i < HTTP_MAX_CLIENTS; i++) {
+      if (!slots[i].active) {
+        target = &slots[i];
+        break;
+      }
+    }
+    if (target == nullptr) {
+      for (uint8_t i = 0; i < HTTP_MAX_CLIENTS; i++) {
+        Slot& s = slots[i];
+        bool idle = s.len == 0 && s.out.length() == 0 && !s.closeAfterFlush;
+        if (idle && (target == nullptr || s.lastActivity < target->lastActivity)) target = &s;
+      }
+      if (target != nullptr) closeSlot(*target);
+    }
+
+    if (target != nullptr) {
+      Slot& s = *target;
+      s.client = listener.accept();
+      s.client.setNoDelay(true);
+      s.active = true;
+      s.len = 0;
+      s.served = false;
+      s.requestStart = millis();
+      s.lastActivity = millis();
+      return;
+    }
+
+    rejected++;
+    WiFiClient extra = listener.accept();
+    const char* busy = "HTTP/1.1 503 Service Unavailable\r\n"
+                       "Content-Length: 0\r\nConnection: close\r\n\r\n";
+    ::send(extra.fd(), busy, strlen(busy), MSG_DONTWAIT);
+    extra.stop();
+  }
+
+  void closeSlot(Slot& s) {
+    s.client.stop();
+    s.active = false;
+    s.len = 0;
+    s.out = String();
+    s.outPos = 0;
+    s.closeAfterFlush = false;
+  }
+
+  // Reply without dispatching, then drop the connection
+  void rejectSlot(Slot& s, int code) {
+    rejected++;
+    current = &s;
+    keepAlive = false;
+    responded = false;
+    extraHeaders = "";
+    send(code, "text/plain", statusText(code));
+    current = nullptr;
+    s.closeAfterFlush = true;
+  }
+
+  // Write as much queued output as the socket accepts without blocking.
+  // Returns false if the connection failed.
+  bool flushOutput(Slot& s) {
+    while (s.outPos < s.out.length()) {
+      int n = ::send(s.client.fd(), s.out.c_str() + s.outPos, s.out.length() - s.outPos, MSG_DONTWAIT);
+      if (n > 0) {
+        s.outPos += n;
+        s.lastActivity = millis();
+      } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        return true;  // Socket buffer full, retry next tick
+      } else {
+        return false;
+      }
+    }
+    s.out = String();
+    s.outPos = 0;
+    return true;
+  }
+
+  void serviceSlot(Slot& s) {
+    if (!s.active) return;
+
+    // Finish the previous response before reading more requests, so a
+    // client that stops reading only holds up its own slot
+    if (s.out.length() > 0 && !flushOutput(s)) {
+      closeSlot(s);
+      return;
+    }
+    if (s.out.length() > 0) {
+      if (millis() - s.lastActivity > HTTP_IDLE_TIMEOUT) closeSlot(s);
+      return;
+    }
+    if (s.closeAfterFlush) {
+      closeSlot(s);
+      return;
+    }
+
+    int avail = s.client.available();
+    if (avail > 0) {
+      size_t room = HTTP_REQUEST_BUFFER - s.len;
+      if (room > 0) {
+        int n = s.client.read((uint8_t*)s.buf + s.len, min((size_t)avail, room));
+        if (n > 0) {
+          if (s.len == 0) s.requestStart = millis();
+          s.len += n;
+          s.lastActivity = millis();
+        }
+      }
+    } else if (s.len == 0 && !s.client.connected()) {
+      closeSlot(s);
+      return;
+    }
+
+    if (s.len > 0) {
+      size_t consumed = processRequest(s);
+      if (consumed > 0) {
+        // Keep any pipelined bytes for the next tick
+        memmove(s.buf, s.buf + consumed, s.len - consumed);
+        s.len -= consumed;
+        s.served = true;
+        s.requestStart = millis();
+        s.lastActivity = millis();
+      } else if (s.len >= HTTP_REQUEST_BUFFER) {
+        rejectSlot(s, 431);
+        s.len = 0;
+      }
+      // Start sending now; whatever the socket cannot take goes out later
+      if (!flushOutput(s)) {
+        closeSlot(s);
+        return;
+      }
+    }
+
+    // New or part-sent requests get HTTP_REQUEST_TIMEOUT in total, so
+    // silent or trickling connections cannot hold a slot; idle keep-alive
+    // connections get HTTP_IDLE_TIMEOUT
+    bool receiving = s.len > 0 || !s.served;
+    if (receiving && millis() - s.requestStart > HTTP_REQUEST_TIMEOUT) {
+      closeSlot(s);
+    } else if (millis() - s.lastActivity > HTTP_IDLE_TIMEOUT) {
+      closeSlot(s);
+    }
+  }
+
+  // Parse and answer one complete request at the head of the buffer.
+  // Returns bytes consumed, or 0 if the request is not complete yet.
+  size_t processRequest(Slot& s) {
+    s.buf[s.len] = '\0';
+    char* headerEnd = strstr(s.buf, "\r\n\r\n");
+    if (headerEnd == nullptr) return 0;
+    size_t headerLen = headerEnd - s.buf + 4;
+
+    // Scan headers for body length and connection preference
+    char* lineEnd = strstr(s.buf, "\r\n");
+    size_t contentLength = 0;
+    bool badLength = false;
+    String connection = "";
+    char* p = lineEnd + 2;
+    while (p < headerEnd + 2) {
+      char* eol = strstr(p, "\r\n");
+      if (strncasecmp(p, "Content-Length:", 15) == 0) {
+        // Digits only, optionally padded with spaces; no sign, no junk
+        const char* v = p + 15;
+        while (*v == ' ' || *v == '\t') v++;
+        char* endp = (char*)v;
+        unsigned long value = isdigit((unsigned char)*v) ? strtoul(v, &endp, 10) : 0;
+        while (*endp == ' ' || *endp == '\t') endp++;
+        if (endp == v || endp != eol) badLength = true;
+        else if (value > HTTP_REQUEST_BUFFER) contentLength = HTTP_REQUEST_BUFFER + 1;  // Too large, avoid overflow
+        else contentLength = value;
+      } else if (strncasecmp(p, "Connection:", 11) == 0) {
+        *eol = '\0';
+        connection = String(p + 11);
+        connection.toLowerCase();
+        *eol = '\r';
+      }
+      p = eol + 2;
+    }
+
+    if (badLength) {
+      rejectSlot(s, 400);
+      return s.len;
+    }
+    // headerLen <= s.len <= HTTP_REQUEST_BUFFER, so the subtraction cannot wrap
+    if (contentLength > HTTP_REQUEST_BUFFER - headerLen) {
+      rejectSlot(s, 413);
+      return s.len;
+    }
+    if (s.len < headerLen + contentLength) return 0;
+
+    // Request line: METHOD SP target SP version
+    *lineEnd = '\0';
+    String requestLine = s.buf;
+    int sp1 = requestLine.indexOf(' ');
+    int sp2 = requestLine.lastIndexOf(' ');
+    if (sp1 < 0 || sp2 <= sp1) {
+      rejectSlot(s, 400);
+      return s.len;
+    }
+    String methodStr = requestLine.substring(0, sp1);
+    String target = requestLine.substring(sp1 + 1, sp2);
+    String version = requestLine.substring(sp2 + 1);
+
+    HTTPMethod method;
+    if (methodStr == "GET") method = HTTP_GET;
+    else if (methodStr == "POST") method = HTTP_POST;
+    else {
+      rejectSlot(s, 501);
+      return s.len;
+    }
+
+    if (version == "HTTP/1.1") keepAlive = connection.indexOf("close") < 0;
+    else keepAlive = connection.indexOf("keep-alive") >= 0;
+
+    // Collect query and form-encoded body arguments
+    argCount = 0;
+    String path = target;
+    int q = target.indexOf('?');
+    if (q >= 0) {
+      path = target.substring(0, q);
+      String query = target.substring(q + 1);
+      parseArgs(query.c_str(), query.length());
+    }
+    if (contentLength > 0) {
+      parseArgs(s.buf + headerLen, contentLength);
+    }
+
+    current = &s;
+    responded = false;
+    extraHeaders = "";
+
+    HttpHandler handler = nullptr;
+    for (uint8_t i = 0; i < routeCount; i++) {
+      if (path == routes[i].uri && (routes[i].method == HTTP_ANY || routes[i].method == method)) {
+        handler = routes[i].handler;
+        break;
+      }
+    }
+    if (handler != nullptr) handler();
+    else send(404, "text/plain", "Not found");
+    if (!responded) send(500, "text/plain", "No response");
+
+    current = nullptr;
+    size_t consumed = headerLen + contentLength;
+    if (!keepAlive) {
+      s.closeAfterFlush = true;
+    }
+    return consumed;
+  }
+
+  // Split "a=1&b=2" into the argument table
+  void parseArgs(const char* data, size_t len) {
+    size_t start = 0;
+    while (start < len && argCount < HTTP_MAX_ARGS) {
+      size_t end = start;
+      while (end < len && data[end] != '&') end++;
+      size_t eq = start;
+      while (eq < end && data[eq] != '=') eq++;
+      if (end > start) {
+        argNames[argCount] = urlDecode(data + start, eq - start);
+        argValues[argCount] = (eq < end) ? urlDecode(data + eq + 1, end - eq - 1) : "";
+        argCount++;
+      }
+      start = end + 1;
+    }
+  }
+
+  static String urlDecode(const char* data, size_t len) {
+    String out;
+    out.reserve(len);
+    for (size_t i = 0; i < len; i++) {
+      char c = data[i];
+      if (c == '+') {
+        out += ' ';
+      } else if (c == '%' && i + 2 < len && isxdigit(data[i + 1]) && isxdigit(data[i + 2])) {
+        char hex[3] = { data[i + 1], data[i + 2], '\0' };
+        out += (char)strtol(hex, nullptr, 16);
+        i += 2;
+      } else {
+        out += c;
+      }
+    }
+    return out;
+  }
+};
+
+#endif // HTTP_SERVER_H
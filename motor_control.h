@@ -5,6 +5,7 @@
 #define MOTOR_CONTROL_H
 
 #include "config.h"
+#include "hall_sensor.h"
 
 // Direction tracking
 int8_t currentDir = DIR_NONE;
@@ -82,4 +83,15 @@ void moveDeskDown() {
   currentDir = DIR_UP;
 }
 
+// Start non-blocking move to target height; loop() stops it on arrival
+void startMoveToHeight(float targetHeight) {
+  moveTargetPulses = heightToPulses(targetHeight);
+  moveStartTime = millis();
+  abortMovement = false;
+  isMoving = true;
+
+  // Decide direction based on pulse count
+  if (moveTargetPulses > pulseCount) moveDeskUp(); else moveDeskDown();
+}
+
 #endif // MOTOR_CONTROL_H
\ No newline at end of file
@@ -0,0 +1,285 @@
+// programs.h
+// On-device move programs: stored sit/stand sequences run from the main loop
+
+#ifndef PROGRAMS_H
+#define PROGRAMS_H
+
+#include <time.h>
+#include "config.h"
+#include "motor_control.h"
+
+// Step types
+enum { STEP_DELAY = 0, STEP_AT = 1 };
+
+// One step: wait, then move to heightMm
+struct ProgramStep {
+  uint8_t  type;      // STEP_DELAY or STEP_AT
+  uint8_t  reserved;
+  uint16_t heightMm;  // Target height in millimetres
+  uint32_t when;      // STEP_DELAY: seconds to wait, STEP_AT: seconds since midnight
+};
+
+struct DeskProgram {
+  uint8_t stepCount;
+  uint8_t repeat;     // 1 = start over after the last step
+  uint8_t reserved[2];
+  ProgramStep steps[PROGRAM_MAX_STEPS];
+};
+
+static_assert(sizeof(ProgramStep) == PROGRAM_STEP_BYTES, "ProgramStep layout changed");
+static_assert(sizeof(DeskProgram) == PROGRAM_BYTES, "DeskProgram layout changed");
+
+// Runner states
+enum { PROGRAM_IDLE = 0, PROGRAM_WAITING = 1, PROGRAM_DUE = 2, PROGRAM_MOVING = 3 };
+
+// Program storage (RAM copy of the EEPROM slots)
+DeskProgram programs[PROGRAM_SLOTS];
+
+// Runner state
+int8_t activeProgram = -1;
+uint8_t activeStep = 0;
+uint8_t programState = PROGRAM_IDLE;
+unsigned long stepArmedTime = 0;      // millis() when the current step started waiting
+unsigned long lastProgramMove = 0;    // millis() when the program last started a move
+long lastSecondsOfDay = -1;           // Last clock reading, for STEP_AT crossing detection
+unsigned long lastClockCheck = 0;
+
+int programSlotAddr(uint8_t slot) {
+  return EEPROM_PROGRAMS_ADDR + slot * PROGRAM_BYTES;
+}
+
+// Seconds since local midnight, or -1 if the clock is not synced yet.
+// Reads time() directly: getLocalTime() delays 10 ms while unsynced.
+long secondsOfDay() {
+  time_t epoch = time(nullptr);
+  if (epoch < CLOCK_VALID_AFTER) return -1;
+  struct tm now;
+  localtime_r(&epoch, &now);
+  return now.tm_hour * 3600L + now.tm_min * 60L + now.tm_sec;
+}
+
+// Start waiting for the current step
+void armProgramStep() {
+  programState = PROGRAM_WAITING;
+  stepArmedTime = millis();
+  lastSecondsOfDay = secondsOfDay();
+  lastClockCheck = millis();
+}
+
+// Load all program slots from EEPROM
+void loadPrograms() {
+  int magic = EEPROM.readInt(EEPROM_PROGRAMS_MAGIC_ADDR);
+  if (magic != EEPROM_PROGRAMS_MAGIC) {
+    // First use of the program area - store empty slots
+    Serial.println("Initializing program storage");
+    memset(programs, 0, sizeof(programs));
+    for (uint8_t i = 0; i < PROGRAM_SLOTS; i++) {
+      EEPROM.put(programSlotAddr(i), programs[i]);
+    }
+    EEPROM.write(EEPROM_RUNNER_ADDR, 0);
+    EEPROM.writeInt(EEPROM_PROGRAMS_MAGIC_ADDR, EEPROM_PROGRAMS_MAGIC);
+    EEPROM.commit();
+    return;
+  }
+
+  for (uint8_t i = 0; i < PROGRAM_SLOTS; i++) {
+    EEPROM.get(programSlotAddr(i), programs[i]);
+    if (programs[i].stepCount > PROGRAM_MAX_STEPS) programs[i].stepCount = 0;
+  }
+  Serial.println("Loaded move programs");
+
+  // Restart the program that was running before reset from its first step
+  int slot = EEPROM.read(EEPROM_RUNNER_ADDR) - 1;
+  if (slot >= 0 && slot < PROGRAM_SLOTS && programs[slot].stepCount > 0) {
+    activeProgram = slot;
+    activeStep = 0;
+    lastProgramMove = millis() - PROGRAM_MIN_MOVE_INTERVAL * 1000UL;
+    armProgramStep();
+    Serial.println("Restarted program " + String(slot));
+  }
+}
+
+// Save one program slot to EEPROM
+void saveProgram(uint8_t slot) {
+  EEPROM.put(programSlotAddr(slot), programs[slot]);
+  EEPROM.commit();
+  Serial.println("Saved program " + String(slot));
+}
+
+// Save which program is running so a reboot restarts it. Only called on
+// start, cancel and finish, not per step, to spare the flash.
+void saveProgramRunner() {
+  EEPROM.write(EEPROM_RUNNER_ADDR, (uint8_t)(activeProgram + 1));
+  EEPROM.commit();
+}
+
+// Start a program, replacing any running one (one runner save, not two)
+void startProgram(uint8_t slot) {
+  if (activeProgram >= 0) Serial.println("Program " + String(activeProgram) + " cancelled");
+  activeProgram = slot;
+  activeStep = 0;
+  lastProgramMove = millis() - PROGRAM_MIN_MOVE_INTERVAL * 1000UL;  // First move is not held back
+  armProgramStep();
+  saveProgramRunner();
+  Serial.println("Program " + String(slot) + " started");
+}
+
+void cancelProgram() {
+  if (activeProgram < 0) return;
+  Serial.println("Program " + String(activeProgram) + " cancelled");
+  activeProgram = -1;
+  programState = PROGRAM_IDLE;
+  saveProgramRunner();
+}
+
+// True once the current step's wait is over
+bool programStepDue(const ProgramStep& step) {
+  if (step.type == STEP_DELAY) {
+    return millis() - stepArmedTime >= step.when * 1000UL;
+  }
+
+  // STEP_AT: read the clock at most once a second and fire when it
+  // crosses the step time (including across midnight)
+  if (millis() - lastClockCheck < 1000) return false;
+  lastClockCheck = millis();
+  long now = secondsOfDay();
+  if (now < 0) return false;
+  long prev = lastSecondsOfDay;
+  lastSecondsOfDay = now;
+  if (prev < 0) return false;
+  long at = step.when;
+  if (prev <= now) return prev < at && at <= now;
+  return prev < at || at <= now;
+}
+
+// Advance the running program; called on every loop, constant work per call
+void handlePrograms() {
+  if (activeProgram < 0) return;
+  DeskProgram& prog = programs[activeProgram];
+
+  if (programState == PROGRAM_MOVING) {
+    if (isMoving) return;
+    activeStep++;
+    if (activeStep >= prog.stepCount) {
+      if (!prog.repeat) {
+        Serial.println("Program " + String(activeProgram) + " finished");
+        activeProgram = -1;
+        programState = PROGRAM_IDLE;
+        saveProgramRunner();
+        return;
+      }
+      activeStep = 0;
+    }
+    armProgramStep();
+    return;
+  }
+
+  const ProgramStep& step = prog.steps[activeStep];
+  if (programState == PROGRAM_WAITING) {
+    if (!programStepDue(step)) return;
+    programState = PROGRAM_DUE;
+  }
+
+  // Every move ends with a ToF calibration and an EEPROM commit, so program
+  // moves are held at least PROGRAM_MIN_MOVE_INTERVAL apart however short
+  // the delays are
+  if (millis() - lastProgramMove < PROGRAM_MIN_MOVE_INTERVAL * 1000UL) return;
+  lastProgramMove = millis();
+
+  Serial.println("Program " + String(activeProgram) + " step " + String(activeStep) +
+                 ": moving to " + String(step.heightMm / 10.0, 1) + " cm");
+  programState = PROGRAM_MOVING;
+  startMoveToHeight(step.heightMm / 10.0);
+}
+
+// True if text is a non-empty run of decimal digits (no sign)
+bool isAllDigits(const String& text) {
+  if (text.length() == 0 || text.length() > 9) return false;
+  for (unsigned i = 0; i < text.length(); i++) {
+    if (!isdigit((unsigned char)text[i])) return false;
+  }
+  return true;
+}
+
+// True if text is digits with at most one decimal point, e.g. "72" or "72.5"
+bool isDecimal(const String& text) {
+  if (text.length() == 0 || text.length() > 9) return false;
+  bool digit = false, point = false;
+  for (unsigned i = 0; i < text.length(); i++) {
+    if (text[i] == '.') {
+      if (point) return false;
+      point = true;
+    } else if (isdigit((unsigned char)text[i])) {
+      digit = true;
+    } else {
+      return false;
+    }
+  }
+  return digit;
+}
+
+// Parse "d600:75.0,t0830:105" into a program.
+// d<seconds>:<cm> waits after the previous step, t<HHMM>:<cm> waits for a time of day.
+// Returns an empty string on success, otherwise an error message.
+String parseProgramSteps(const String& text, bool repeat, DeskProgram& prog) {
+  memset(&prog, 0, sizeof(prog));
+  prog.repeat = repeat ? 1 : 0;
+  int start = 0;
+  while (start < (int)text.length()) {
+    int end = text.indexOf(',', start);
+    if (end < 0) end = text.length();
+    String token = text.substring(start, end);
+    start = end + 1;
+    if (token.length() == 0) continue;
+
+    if (prog.stepCount >= PROGRAM_MAX_STEPS) return "Too many steps";
+    int colon = token.indexOf(':');
+    if (colon < 2) return "Bad step " + token;
+
+    ProgramStep& step = prog.steps[prog.stepCount];
+    String field = token.substring(1, colon);
+    if (!isAllDigits(field)) return "Bad step " + token;
+    long value = field.toInt();
+    String heightText = token.substring(colon + 1);
+    if (!isDecimal(heightText)) return "Bad height " + token;
+    float height = heightText.toFloat();
+    if (height < MIN_HEIGHT_CM || height > MAX_HEIGHT_CM) return "Out of bounds " + token;
+
+    if (token[0] == 'd') {
+      if (value < 0 || value > (long)PROGRAM_MAX_DELAY) return "Bad delay " + token;
+      step.type = STEP_DELAY;
+      step.when = value;
+    } else if (token[0] == 't') {
+      long hh = value / 100, mm = value % 100;
+      if (colon != 5 || hh < 0 || hh > 23 || mm < 0 || mm > 59) return "Bad time " + token;
+      step.type = STEP_AT;
+      step.when = hh * 3600 + mm * 60;
+    } else {
+      return "Bad step " + token;
+    }
+    step.heightMm = (uint16_t)(height * 10 + 0.5);
+    prog.stepCount++;
+  }
+
+  return "";
+}
+
+// Format a program back into the upload syntax
+String formatProgramSteps(const DeskProgram& prog) {
+  String out = "";
+  for (uint8_t i = 0; i < prog.stepCount; i++) {
+    const ProgramStep& step = prog.steps[i];
+    if (i > 0) out += ",";
+    if (step.type == STEP_AT) {
+      char buf[16];
+      snprintf(buf, sizeof(buf), "t%02lu%02lu", (unsigned long)(step.when / 3600), (unsigned long)(step.when % 3600 / 60));
+      out += buf;
+    } else {
+      out += "d" + String((unsigned long)step.when);
+    }
+    out += ":" + String(step.heightMm / 10.0, 1);
+  }
+  return out;
+}
+
+#endif // PROGRAMS_H
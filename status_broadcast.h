@@ -0,0 +1,66 @@
+// status_broadcast.h
+// Binary status record and periodic UDP multicast for fleet monitoring
+
+#ifndef STATUS_BROADCAST_H
+#define STATUS_BROADCAST_H
+
+#include "config.h"
+#include "hall_sensor.h"
+#include "programs.h"
+#include "http_server.h"
+#include "status_record.h"
+
+// Web server instance (defined in web_interface.h)
+extern DeskHttpServer server;
+
+WiFiUDP statusUdp;
+IPAddress statusGroup(STATUS_MULTICAST_IP[0], STATUS_MULTICAST_IP[1], STATUS_MULTICAST_IP[2], STATUS_MULTICAST_IP[3]);
+uint8_t statusMac[6];
+uint32_t statusSequence = 0;
+unsigned long lastStatusBroadcast = 0;
+
+// Fill a status record with the current desk state
+void buildStatusRecord(DeskStatusRecord& rec) {
+  memset(&rec, 0, sizeof(rec));
+  memcpy(rec.magic, "DSKS", 4);
+  rec.version = STATUS_RECORD_VERSION;
+  if (isMoving) rec.flags |= STATUS_FLAG_MOVING;
+  if (activeProgram >= 0) rec.flags |= STATUS_FLAG_PROGRAM;
+  // currentDir names the PWM pin in use, which is the opposite of travel:
+  // moveDeskUp() sets DIR_DOWN and moveDeskDown() sets DIR_UP
+  rec.direction = -currentDir;
+  rec.program = activeProgram;
+  memcpy(rec.mac, statusMac, sizeof(statusMac));
+  rec.sequence = statusSequence;
+  rec.uptimeMs = millis();
+  rec.pulses = pulseCount;
+  rec.targetPulses = moveTargetPulses;
+  rec.heightMm = (int16_t)lroundf(pulsesToHeight(rec.pulses) * 10);
+  rec.targetMm = (int16_t)lroundf(pulsesToHeight(rec.targetPulses) * 10);
+  rec.moveTimeouts = moveTimeoutCount;
+  rec.tofErrors = tofErrorCount;
+  rec.httpRejects = server.rejectedCount();
+}
+
+// Call after Wi-Fi is connected
+void initStatusBroadcast() {
+  WiFi.macAddress(statusMac);
+  Serial.println("Status multicast to " + statusGroup.toString() + ":" + String(STATUS_MULTICAST_PORT));
+}
+
+// Send the status record every STATUS_BROADCAST_INTERVAL (faster while moving)
+void handleStatusBroadcast() {
+  unsigned long interval = isMoving ? STATUS_BROADCAST_MOVING_INTERVAL : STATUS_BROADCAST_INTERVAL;
+  if (millis() - lastStatusBroadcast < interval) return;
+  lastStatusBroadcast = millis();
+  if (WiFi.status() != WL_CONNECTED) return;
+
+  DeskStatusRecord rec;
+  buildStatusRecord(rec);
+  rec.sequence = ++statusSequence;
+  statusUdp.beginPacket(statusGroup, STATUS_MULTICAST_PORT);
+  statusUdp.write((const uint8_t*)&rec, sizeof(rec));
+  statusUdp.endPacket();
+}
+
+#endif // STATUS_BROADCAST_H
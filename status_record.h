@@ -0,0 +1,39 @@
+// status_record.h
+// Fixed-layout binary status record, shared by the firmware and tools/desk_collector.cpp
+
+#ifndef STATUS_RECORD_H
+#define STATUS_RECORD_H
+
+#include <stdint.h>
+
+const uint8_t STATUS_RECORD_VERSION = 1;
+
+// Status flags
+const uint8_t STATUS_FLAG_MOVING  = 0x01;  // Move to target in progress
+const uint8_t STATUS_FLAG_PROGRAM = 0x02;  // Move program running
+
+// 44 bytes, packed, little-endian. Served by /status.bin and sent by
+// UDP multicast. Bump STATUS_RECORD_VERSION when the layout changes.
+struct __attribute__((packed)) DeskStatusRecord {
+  char     magic[4];          // "DSKS"
+  uint8_t  version;           // STATUS_RECORD_VERSION
+  uint8_t  flags;             // STATUS_FLAG_*
+  int8_t   direction;         // Physical travel: DIR_UP (desk rising), DIR_DOWN or DIR_NONE
+  int8_t   program;           // Running program slot, -1 if none
+  uint8_t  mac[6];            // Station MAC, identifies the desk
+  uint16_t reserved;
+  uint32_t sequence;          // Multicast packet counter, gaps mean lost packets
+  uint32_t uptimeMs;
+  int32_t  pulses;
+  int32_t  targetPulses;
+  int16_t  heightMm;
+  int16_t  targetMm;
+  uint16_t moveTimeouts;      // Moves stopped by MOVEMENT_TIMEOUT
+  uint16_t tofErrors;         // Calibrations without a valid ToF reading
+  uint16_t httpRejects;       // HTTP connections or requests refused
+  uint16_t reserved2;
+};
+
+static_assert(sizeof(DeskStatusRecord) == 44, "DeskStatusRecord layout changed");
+
+#endif // STATUS_RECORD_H
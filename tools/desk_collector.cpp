@@ -0,0 +1,145 @@
+// desk_collector.cpp
+// Linux collector for desk status multicast (see status_broadcast.h)
+//
+// Build: g++ -std=c++11 -O2 -I. -o desk_collector tools/desk_collector.cpp
+// Usage: ./desk_collector [group] [port]
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <map>
+#include <string>
+
+#include "status_record.h"
+
+const char* DEFAULT_GROUP = "239.255.77.77";
+const int DEFAULT_PORT = 47077;
+const int STALE_SECONDS = 5;  // Mark desks silent for this long as stale
+
+struct DeskEntry {
+  DeskStatusRecord rec;
+  std::string addr;
+  time_t lastSeen;
+  unsigned long received;
+  unsigned long lost;  // Gaps in the sequence number
+};
+
+// Multicast records are little-endian; convert for big-endian hosts
+static void fromLittleEndian(DeskStatusRecord& r) {
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  r.sequence = __builtin_bswap32(r.sequence);
+  r.uptimeMs = __builtin_bswap32(r.uptimeMs);
+  r.pulses = (int32_t)__builtin_bswap32((uint32_t)r.pulses);
+  r.targetPulses = (int32_t)__builtin_bswap32((uint32_t)r.targetPulses);
+  r.heightMm = (int16_t)__builtin_bswap16((uint16_t)r.heightMm);
+  r.targetMm = (int16_t)__builtin_bswap16((uint16_t)r.targetMm);
+  r.moveTimeouts = __builtin_bswap16(r.moveTimeouts);
+  r.tofErrors = __builtin_bswap16(r.tofErrors);
+  r.httpRejects = __builtin_bswap16(r.httpRejects);
+#else
+  (void)r;
+#endif
+}
+
+static void printTable(const std::map<std::string, DeskEntry>& desks) {
+  time_t now = time(nullptr);
+  printf("\033[H\033[2J");
+  printf("%-17s  %-15s  %7s  %7s  %6s  %4s  %4s  %9s  %5s  %5s  %5s  %5s\n",
+         "MAC", "ADDRESS", "HEIGHT", "TARGET", "PULSES", "DIR", "PROG",
+         "UPTIME", "TMOUT", "TOF", "HTTP", "LOST");
+  for (const auto& kv : desks) {
+    const DeskEntry& d = kv.second;
+    const DeskStatusRecord& r = d.rec;
+    const char* dir = r.direction > 0 ? "up" : r.direction < 0 ? "down" : "-";
+    char prog[8];
+    if (r.program >= 0) snprintf(prog, sizeof(prog), "%d", r.program);
+    else snprintf(prog, sizeof(prog), "-");
+    char target[16];
+    if (r.flags & STATUS_FLAG_MOVING) snprintf(target, sizeof(target), "%.1f", r.targetMm / 10.0);
+    else snprintf(target, sizeof(target), "-");
+    printf("%-17s  %-15s  %7.1f  %7s  %6d  %4s  %4s  %8lus  %5u  %5u  %5u  %5lu%s\n",
+           kv.first.c_str(), d.addr.c_str(), r.heightMm / 10.0, target, r.pulses, dir, prog,
+           (unsigned long)(r.uptimeMs / 1000), r.moveTimeouts, r.tofErrors, r.httpRejects,
+           d.lost, now - d.lastSeen > STALE_SECONDS ? "  (stale)" : "");
+  }
+  fflush(stdout);
+}
+
+int main(int argc, char** argv) {
+  const char* group = argc > 1 ? argv[1] : DEFAULT_GROUP;
+  int port = argc > 2 ? atoi(argv[2]) : DEFAULT_PORT;
+
+  int fd = socket(AF_INET, SOCK_DGRAM, 0);
+  if (fd < 0) { perror("socket"); return 1; }
+  int one = 1;
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+  sockaddr_in local;
+  memset(&local, 0, sizeof(local));
+  local.sin_family = AF_INET;
+  local.sin_port = htons(port);
+  local.sin_addr.s_addr = htonl(INADDR_ANY);
+  if (bind(fd, (sockaddr*)&local, sizeof(local)) < 0) { perror("bind"); return 1; }
+
+  ip_mreq mreq;
+  memset(&mreq, 0, sizeof(mreq));
+  if (inet_pton(AF_INET, group, &mreq.imr_multiaddr) != 1) {
+    fprintf(stderr, "Invalid group address %s\n", group);
+    return 1;
+  }
+  mreq.imr_interface.s_addr = htonl(INADDR_ANY);
+  if (setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) < 0) {
+    perror("IP_ADD_MEMBERSHIP");
+    return 1;
+  }
+
+  // Wake up at least once a second to refresh the table
+  timeval tv = {1, 0};
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+  std::map<std::string, DeskEntry> desks;
+  time_t lastPrint = 0;
+  printf("Listening on %s:%d\n", group, port);
+
+  for (;;) {
+    DeskStatusRecord rec;
+    sockaddr_in from;
+    socklen_t fromLen = sizeof(from);
+    ssize_t n = recvfrom(fd, &rec, sizeof(rec), 0, (sockaddr*)&from, &fromLen);
+
+    if (n == (ssize_t)sizeof(rec) && memcmp(rec.magic, "DSKS", 4) == 0 &&
+        rec.version == STATUS_RECORD_VERSION) {
+      fromLittleEndian(rec);
+      char mac[18];
+      snprintf(mac, sizeof(mac), "%02x:%02x:%02x:%02x:%02x:%02x",
+               rec.mac[0], rec.mac[1], rec.mac[2], rec.mac[3], rec.mac[4], rec.mac[5]);
+      char addr[INET_ADDRSTRLEN];
+      inet_ntop(AF_INET, &from.sin_addr, addr, sizeof(addr));
+
+      auto it = desks.find(mac);
+      if (it == desks.end()) {
+        DeskEntry entry;
+        entry.received = 0;
+        entry.lost = 0;
+        it = desks.insert(std::make_pair(std::string(mac), entry)).first;
+      } else if (rec.sequence > it->second.rec.sequence + 1) {
+        it->second.lost += rec.sequence - it->second.rec.sequence - 1;
+      }
+      it->second.rec = rec;
+      it->second.addr = addr;
+      it->second.lastSeen = time(nullptr);
+      it->second.received++;
+    }
+
+    if (time(nullptr) != lastPrint) {
+      lastPrint = time(nullptr);
+      printTable(desks);
+    }
+  }
+}
@@ -0,0 +1,102 @@
+// Arduino.h
+// Host simulator: minimal Arduino core (String, timing, GPIO/PWM no-ops) on Linux
+
+#ifndef HOST_SIM_ARDUINO_H
+#define HOST_SIM_ARDUINO_H
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+
+using std::max;
+using std::min;
+
+// Arduino String on top of std::string, covering what the sketch uses
+class String : public std::string {
+public:
+  String() {}
+  String(const char* s) : std::string(s ? s : "") {}
+  String(const std::string& s) : std::string(s) {}
+  String(char c) : std::string(1, c) {}
+  String(int v) : std::string(std::to_string(v)) {}
+  String(unsigned v) : std::string(std::to_string(v)) {}
+  String(long v) : std::string(std::to_string(v)) {}
+  String(unsigned long v) : std::string(std::to_string(v)) {}
+  String(double v, int decimals = 2) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.*f", decimals, v);
+    assign(buf);
+  }
+
+  unsigned length() const { return size(); }
+  int indexOf(char c, unsigned from = 0) const { return pos(find(c, from)); }
+  int indexOf(const char* s, unsigned from = 0) const { return pos(find(s, from)); }
+  int lastIndexOf(char c) const { return pos(rfind(c)); }
+  String substring(unsigned from) const { return from >= size() ? String() : String(substr(from)); }
+  String substring(unsigned from, unsigned to) const {
+    return from >= size() ? String() : String(substr(from, to - from));
+  }
+  void toLowerCase() { for (auto& c : *this) c = tolower((unsigned char)c); }
+  long toInt() const { return atol(c_str()); }
+  float toFloat() const { return atof(c_str()); }
+
+  bool concat(const char* s, unsigned len) { append(s, len); return true; }
+  String& operator+=(const String& s) { append(s); return *this; }
+  String& operator+=(const char* s) { append(s); return *this; }
+  String& operator+=(char c) { push_back(c); return *this; }
+
+private:
+  static int pos(size_t p) { return p == npos ? -1 : (int)p; }
+};
+
+inline String operator+(const String& a, const String& b) { String r(a); r.append(b); return r; }
+inline String operator+(const String& a, const char* b) { String r(a); r.append(b); return r; }
+inline String operator+(const char* a, const String& b) { String r(a); r.append(b); return r; }
+
+inline unsigned long micros() {
+  static auto start = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+inline unsigned long millis() { return micros() / 1000; }
+inline void delay(unsigned long ms) { usleep(ms * 1000); }
+
+// GPIO and PWM do nothing: the Hall sensors never pulse, so moves end by MOVEMENT_TIMEOUT
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+inline void pinMode(int, int) {}
+inline int digitalRead(int) { return LOW; }
+inline void digitalWrite(int, int) {}
+inline void ledcAttach(int, int, int) {}
+inline void ledcWrite(int, int) {}
+
+// Serial output is discarded to keep benchmark runs quiet
+struct HostSerial {
+  void begin(long) {}
+  template <class T> void print(const T&) {}
+  template <class T> void print(const T&, int) {}
+  template <class T> void println(const T&) {}
+  void println() {}
+};
+extern HostSerial Serial;
+
+inline void configTzTime(const char*, const char*) {}
+
+#endif // HOST_SIM_ARDUINO_H
@@ -0,0 +1,46 @@
+// EEPROM.h
+// Host simulator: EEPROM kept in a file (HOST_SIM_EEPROM, default desk_sim_eeprom.bin)
+
+#ifndef HOST_SIM_EEPROM_H
+#define HOST_SIM_EEPROM_H
+
+#include <stdint.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+struct HostEEPROM {
+  uint8_t mem[4096];
+
+  static const char* path() {
+    return getenv("HOST_SIM_EEPROM") ? getenv("HOST_SIM_EEPROM") : "desk_sim_eeprom.bin";
+  }
+
+  void begin(int) {
+    memset(mem, 0, sizeof(mem));
+    FILE* f = fopen(path(), "rb");
+    if (f) {
+      size_t n = fread(mem, 1, sizeof(mem), f);
+      (void)n;
+      fclose(f);
+    }
+  }
+
+  bool commit() {
+    FILE* f = fopen(path(), "wb");
+    if (!f) return false;
+    fwrite(mem, 1, sizeof(mem), f);
+    fclose(f);
+    return true;
+  }
+
+  uint8_t read(int addr) { return mem[addr]; }
+  void write(int addr, uint8_t value) { mem[addr] = value; }
+  int readInt(int addr) { int v; memcpy(&v, mem + addr, sizeof(v)); return v; }
+  void writeInt(int addr, int v) { memcpy(mem + addr, &v, sizeof(v)); }
+  template <class T> T& get(int addr, T& t) { memcpy(&t, mem + addr, sizeof(T)); return t; }
+  template <class T> const T& put(int addr, const T& t) { memcpy(mem + addr, &t, sizeof(T)); return t; }
+};
+extern HostEEPROM EEPROM;
+
+#endif // HOST_SIM_EEPROM_H
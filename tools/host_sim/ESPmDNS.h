@@ -0,0 +1,13 @@
+// ESPmDNS.h
+// Host simulator: mDNS no-op
+
+#ifndef HOST_SIM_ESPMDNS_H
+#define HOST_SIM_ESPMDNS_H
+
+struct HostMDNS {
+  bool begin(const char*) { return true; }
+  void addService(const char*, const char*, int) {}
+};
+extern HostMDNS MDNS;
+
+#endif // HOST_SIM_ESPMDNS_H
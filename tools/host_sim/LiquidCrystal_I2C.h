@@ -0,0 +1,17 @@
+// LiquidCrystal_I2C.h
+// Host simulator: LCD no-op
+
+#ifndef HOST_SIM_LCD_H
+#define HOST_SIM_LCD_H
+
+struct LiquidCrystal_I2C {
+  LiquidCrystal_I2C(int, int, int) {}
+  void init() {}
+  void backlight() {}
+  void noBacklight() {}
+  void clear() {}
+  void setCursor(int, int) {}
+  template <class T> void print(const T&) {}
+};
+
+#endif // HOST_SIM_LCD_H
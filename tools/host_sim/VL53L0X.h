@@ -0,0 +1,17 @@
+// VL53L0X.h
+// Host simulator: ToF sensor that always reads 870 mm
+
+#ifndef HOST_SIM_VL53L0X_H
+#define HOST_SIM_VL53L0X_H
+
+#include <stdint.h>
+
+struct VL53L0X {
+  bool init() { return true; }
+  void setTimeout(int) {}
+  void startContinuous() {}
+  uint16_t readRangeContinuousMillimeters() { return 870; }
+  bool timeoutOccurred() { return false; }
+};
+
+#endif // HOST_SIM_VL53L0X_H
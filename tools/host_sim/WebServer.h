@@ -0,0 +1,9 @@
+// WebServer.h
+// Host simulator: only the HTTPMethod values used by http_server.h
+
+#ifndef HOST_SIM_WEBSERVER_H
+#define HOST_SIM_WEBSERVER_H
+
+enum HTTPMethod { HTTP_ANY, HTTP_GET, HTTP_POST };
+
+#endif // HOST_SIM_WEBSERVER_H
@@ -0,0 +1,147 @@
+// WiFi.h
+// Host simulator: WiFiServer/WiFiClient/WiFiUDP on POSIX sockets
+
+#ifndef HOST_SIM_WIFI_H
+#define HOST_SIM_WIFI_H
+
+#include "Arduino.h"
+
+#define WL_CONNECTED 3
+
+struct IPAddress {
+  uint32_t addr = 0;
+  IPAddress() {}
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : addr((a << 24) | (b << 16) | (c << 8) | d) {}
+  String toString() const {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%u.%u.%u.%u", addr >> 24, (addr >> 16) & 255, (addr >> 8) & 255, addr & 255);
+    return buf;
+  }
+};
+
+class WiFiClient {
+public:
+  WiFiClient() {}
+  explicit WiFiClient(int sock) : sock(sock) {}
+
+  int available() {
+    if (sock < 0) return 0;
+    char buf[4096];
+    int n = recv(sock, buf, sizeof(buf), MSG_PEEK | MSG_DONTWAIT);
+    return n > 0 ? n : 0;
+  }
+
+  bool connected() {
+    if (sock < 0) return false;
+    char c;
+    int n = recv(sock, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+    if (n == 0) return false;
+    return n > 0 || errno == EAGAIN || errno == EWOULDBLOCK;
+  }
+
+  int read(uint8_t* buf, size_t len) { return recv(sock, buf, len, MSG_DONTWAIT); }
+
+  int fd() const { return sock; }
+
+  // Blocks until everything is written, like the ESP32 client
+  size_t write(const uint8_t* buf, size_t len) {
+    size_t off = 0;
+    while (off < len) {
+      int n = ::send(sock, buf + off, len - off, MSG_NOSIGNAL);
+      if (n < 0) {
+        if (errno == EAGAIN) { usleep(100); continue; }
+        break;
+      }
+      off += n;
+    }
+    return off;
+  }
+
+  void setNoDelay(bool on) {
+    int flag = on ? 1 : 0;
+    if (sock >= 0) setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+  }
+
+  void stop() {
+    if (sock >= 0) close(sock);
+    sock = -1;
+  }
+
+private:
+  int sock = -1;
+};
+
+// Listens on 127.0.0.1; port 80 is remapped to HOST_SIM_PORT (default 8080)
+class WiFiServer {
+public:
+  WiFiServer(uint16_t port) : port(port) {}
+
+  void begin() {
+    uint16_t bindPort = port;
+    if (port == 80) bindPort = getenv("HOST_SIM_PORT") ? atoi(getenv("HOST_SIM_PORT")) : 8080;
+    fd = socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(bindPort);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(fd, (sockaddr*)&addr, sizeof(addr)) < 0) { perror("bind"); exit(1); }
+    listen(fd, 64);
+    fcntl(fd, F_SETFL, O_NONBLOCK);
+    fprintf(stderr, "HTTP on 127.0.0.1:%u\n", bindPort);
+  }
+
+  void setNoDelay(bool) {}
+
+  bool hasClient() {
+    if (pending < 0) pending = ::accept(fd, nullptr, nullptr);
+    return pending >= 0;
+  }
+
+  WiFiClient accept() {
+    if (!hasClient()) return WiFiClient();
+    WiFiClient client(pending);
+    pending = -1;
+    return client;
+  }
+
+private:
+  uint16_t port;
+  int fd = -1;
+  int pending = -1;
+};
+
+class WiFiUDP {
+public:
+  int beginPacket(IPAddress ip, uint16_t port) {
+    if (fd < 0) fd = socket(AF_INET, SOCK_DGRAM, 0);
+    memset(&dest, 0, sizeof(dest));
+    dest.sin_family = AF_INET;
+    dest.sin_port = htons(port);
+    dest.sin_addr.s_addr = htonl(ip.addr);
+    packet.clear();
+    return 1;
+  }
+  size_t write(const uint8_t* buf, size_t len) { packet.append((const char*)buf, len); return len; }
+  int endPacket() { return sendto(fd, packet.data(), packet.size(), 0, (sockaddr*)&dest, sizeof(dest)) >= 0; }
+
+private:
+  int fd = -1;
+  sockaddr_in dest;
+  std::string packet;
+};
+
+struct HostWiFi {
+  void begin(const char*, const char*) {}
+  int status() { return WL_CONNECTED; }
+  IPAddress localIP() { return IPAddress(127, 0, 0, 1); }
+  void macAddress(uint8_t* mac) {
+    const uint8_t simMac[6] = {0x02, 0x00, 0x00, 0x00, 0x00, 0x01};
+    memcpy(mac, simMac, 6);
+  }
+};
+extern HostWiFi WiFi;
+
+#endif // HOST_SIM_WIFI_H
@@ -0,0 +1,4 @@
+// WiFiUdp.h
+// Host simulator: WiFiUDP lives in WiFi.h
+
+#include "WiFi.h"
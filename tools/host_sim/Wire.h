@@ -0,0 +1,12 @@
+// Wire.h
+// Host simulator: I2C no-op
+
+#ifndef HOST_SIM_WIRE_H
+#define HOST_SIM_WIRE_H
+
+struct HostWire {
+  void begin(int, int) {}
+};
+extern HostWire Wire;
+
+#endif // HOST_SIM_WIRE_H
@@ -0,0 +1,47 @@
+// host_sim.cpp
+// Runs the desk sketch on Linux for HTTP load tests and collector checks
+//
+// Build: g++ -std=gnu++17 -O2 -Itools/host_sim -I. -o desk_sim tools/host_sim/host_sim.cpp
+// Run:   ./desk_sim            (HTTP on 127.0.0.1:8080, status multicast as on the desk)
+
+#include "Arduino.h"
+#include "WiFi.h"
+#include "ESPmDNS.h"
+#include "Wire.h"
+#include "EEPROM.h"
+
+HostSerial Serial;
+HostWiFi WiFi;
+HostMDNS MDNS;
+HostWire Wire;
+HostEEPROM EEPROM;
+
+// The Arduino builder generates prototypes; the sketch needs this one
+void calibrateWithTof();
+
+#include "Final_desk_code_setup_hall_tof.ino"
+
+int main() {
+  setup();
+  fprintf(stderr, "Desk simulator ready\n");
+
+  // Report loop rate and the slowest loop() every 5 seconds, so request
+  // handling cost on the control loop is visible during a load test
+  unsigned long windowStart = micros();
+  unsigned long ticks = 0, worstTick = 0;
+  for (;;) {
+    unsigned long start = micros();
+    loop();
+    unsigned long elapsed = micros() - start;
+    if (elapsed > worstTick) worstTick = elapsed;
+    ticks++;
+
+    if (micros() - windowStart >= 5000000) {
+      fprintf(stderr, "loop: %lu ticks/s, slowest %lu us\n", ticks / 5, worstTick);
+      windowStart = micros();
+      ticks = 0;
+      worstTick = 0;
+    }
+    usleep(50);  // Stand-in for the rest of an ESP32 loop iteration
+  }
+}
@@ -0,0 +1,4 @@
+// lwip/sockets.h
+// Host simulator: lwIP's BSD socket API is the POSIX one
+
+#include <sys/socket.h>
@@ -0,0 +1,72 @@
+#!/usr/bin/env python3
+# http_load.py
+# HTTP/1.1 keep-alive load generator for the desk (or tools/host_sim)
+#
+# Usage: tools/http_load.py [--conns 4] [--requests 2000] [--pipeline 8]
+#                           [--host 127.0.0.1] [--port 8080] [--path /height]
+#                           [--secret SECRET]
+#
+# The secret is taken from --secret or the DESK_SECRET environment variable.
+# Latency is per response: from sending its request to reading its body.
+
+import argparse
+import asyncio
+import os
+import time
+
+
+async def worker(args, latencies):
+    reader, writer = await asyncio.open_connection(args.host, args.port)
+    request = (f"GET {args.path}?secret={args.secret} HTTP/1.1\r\n"
+               f"Host: {args.host}\r\n\r\n").encode()
+    done = 0
+    while done < args.requests:
+        batch = min(args.pipeline, args.requests - done)
+        sent = time.perf_counter()
+        writer.write(request * batch)  # Pipelined: send the batch, then read replies
+        await writer.drain()
+        for _ in range(batch):
+            head = await reader.readuntil(b"\r\n\r\n")
+            status = head.split(b" ", 2)[1]
+            if status != b"200":
+                raise RuntimeError(f"HTTP {status.decode()}: {head!r}")
+            length = 0
+            for line in head.split(b"\r\n"):
+                if line.lower().startswith(b"content-length:"):
+                    length = int(line.split(b":", 1)[1])
+            await reader.readexactly(length)
+            latencies.append(time.perf_counter() - sent)
+        done += batch
+    writer.close()
+    await writer.wait_closed()
+
+
+async def main():
+    parser = argparse.ArgumentParser(description="HTTP keep-alive load generator")
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=8080)
+    parser.add_argument("--path", default="/height")
+    parser.add_argument("--secret", default=os.environ.get("DESK_SECRET"),
+                        help="SECRET_KEY (default: $DESK_SECRET)")
+    parser.add_argument("--conns", type=int, default=4, help="concurrent keep-alive connections")
+    parser.add_argument("--requests", type=int, default=2000, help="requests per connection")
+    parser.add_argument("--pipeline", type=int, default=1, help="requests in flight per connection")
+    args = parser.parse_args()
+    if not args.secret:
+        parser.error("pass --secret or set DESK_SECRET")
+
+    latencies = []
+    start = time.perf_counter()
+    await asyncio.gather(*[worker(args, latencies) for _ in range(args.conns)])
+    elapsed = time.perf_counter() - start
+
+    total = args.conns * args.requests
+    latencies.sort()
+    p50 = latencies[len(latencies) // 2] * 1e3
+    p99 = latencies[min(len(latencies) - 1, int(len(latencies) * 0.99))] * 1e3
+    print(f"conns={args.conns} pipeline={args.pipeline} requests={total} "
+          f"{total / elapsed:.0f} req/s  p50={p50:.2f} ms  p99={p99:.2f} ms")
+
+
+if __name__ == "__main__":
+    asyncio.run(main())
@@ -8,11 +8,12 @@
 #include "hall_sensor.h"
 #include "motor_control.h"
 #include "storage.h"
+#include "programs.h"
+#include "http_server.h"
+#include "status_broadcast.h"
 
-// Web server instance
-WebServer server(80);
-
-
+// Web server instance (multi-client, keep-alive)
+DeskHttpServer server(HTTP_PORT);
 
 // Process web requests
 void handleWebRequests() {
@@ -41,6 +42,14 @@ void handleStatus() {
   server.send(200, "text/plain", isMoving ? "1" : "0");
 }
 
+// Return the binary status record (layout in status_record.h)
+void handleStatusBinary() {
+  if (!isAuthorized()) return;
+  DeskStatusRecord rec;
+  buildStatusRecord(rec);
+  server.send(200, "application/octet-stream", (const uint8_t*)&rec, sizeof(rec));
+}
+
 // Return Hall sensor info
 void handleHallStatus() {
   if (!isAuthorized()) return;
@@ -69,13 +78,8 @@ void handleMoveToTarget() {
   if (targetHeight < MIN_HEIGHT_CM || targetHeight > MAX_HEIGHT_CM) {
     server.send(400,"text/plain","Out of bounds"); return;
   }
-  moveTargetPulses = heightToPulses(targetHeight);
-  moveStartTime = millis();
-  abortMovement = false;
-  isMoving = true;
-  
-  // Decide direction based on pulse count
-  if (moveTargetPulses > pulseCount) moveDeskUp(); else moveDeskDown();
+  cancelProgram();  // A direct move overrides any running program
+  startMoveToHeight(targetHeight);
   server.send(200,"text/plain","Movement started");
 }
 
@@ -92,6 +96,7 @@ void handleManual() {
 
   if (!server.hasArg("dir")) { server.send(400,"text/plain","Missing dir"); return; }
   String d = server.arg("dir");
+  if (d=="up" || d=="down") cancelProgram();
   if (d=="up") moveDeskUp();
   else if (d=="down") moveDeskDown();
   else { server.send(400,"text/plain","Invalid dir"); return; }
@@ -101,6 +106,7 @@ void handleManual() {
 // Stop any motion
 void handleManualStop() {
   if (!isAuthorized()) return;
+  cancelProgram();
   abortMovement = true;
   isMoving = false;
   stopDeskMotor();
@@ -108,6 +114,62 @@ void handleManualStop() {
   server.send(200,"text/plain","Stopped at " + String(height, 1) + " cm");
 }
 
+// Store a move program: /program/upload?slot=0&steps=d1800:105,d3600:72&repeat=1
+void handleProgramUpload() {
+  if (!isAuthorized()) return;
+  if (!server.hasArg("slot") || !server.hasArg("steps")) {
+    server.send(400,"text/plain","Missing slot or steps"); return;
+  }
+  int slot = server.arg("slot").toInt();
+  if (slot < 0 || slot >= PROGRAM_SLOTS) { server.send(400,"text/plain","Invalid slot"); return; }
+
+  DeskProgram prog;
+  String error = parseProgramSteps(server.arg("steps"), server.arg("repeat") == "1", prog);
+  if (error.length() > 0) { server.send(400,"text/plain",error); return; }
+
+  if (activeProgram == slot) cancelProgram();
+  programs[slot] = prog;
+  saveProgram(slot);
+  server.send(200,"text/plain","Program " + String(slot) + " saved (" + String(prog.stepCount) + " steps)");
+}
+
+// List stored programs and the runner state
+void handleProgramList() {
+  if (!isAuthorized()) return;
+  String response = "";
+  for (uint8_t i = 0; i < PROGRAM_SLOTS; i++) {
+    response += "Program " + String(i) + ": ";
+    if (programs[i].stepCount == 0) {
+      response += "empty\n";
+      continue;
+    }
+    response += formatProgramSteps(programs[i]);
+    if (programs[i].repeat) response += " (repeat)";
+    if (activeProgram == i) response += " [running step " + String(activeStep + 1) + "]";
+    response += "\n";
+  }
+  server.send(200,"text/plain",response);
+}
+
+// Run a stored program: /program/run?slot=0
+void handleProgramRun() {
+  if (!isAuthorized()) return;
+  if (!server.hasArg("slot")) { server.send(400,"text/plain","Missing slot"); return; }
+  int slot = server.arg("slot").toInt();
+  if (slot < 0 || slot >= PROGRAM_SLOTS) { server.send(400,"text/plain","Invalid slot"); return; }
+  if (programs[slot].stepCount == 0) { server.send(400,"text/plain","Program empty"); return; }
+  startProgram(slot);
+  server.send(200,"text/plain","Program " + String(slot) + " started");
+}
+
+// Cancel the running program (a move in progress still finishes)
+void handleProgramCancel() {
+  if (!isAuthorized()) return;
+  if (activeProgram < 0) { server.send(200,"text/plain","No program running"); return; }
+  cancelProgram();
+  server.send(200,"text/plain","Program cancelled");
+}
+
 // Web UI
 void handleWebPage() {
   // if missing or wrong secret, force login
@@ -343,10 +405,13 @@ void initWebServer() {
   
   // mDNS setup
   if (MDNS.begin("deskcontrol")) {
-    MDNS.addService("http", "tcp", 80);
+    MDNS.addService("http", "tcp", HTTP_PORT);
     Serial.println("mDNS started (http://deskcontrol.local)");
   }
 
+  // Clock for time-of-day program steps
+  configTzTime(TIME_ZONE, NTP_SERVER);
+
   // Setup route handlers
   server.on("/login", HTTP_GET, handleLoginPage);
   server.on("/login", HTTP_POST, handleLogin);
@@ -357,7 +422,12 @@ void initWebServer() {
   server.on("/stop", handleManualStop);
   server.on("/status", handleStatus);
   server.on("/hall", handleHallStatus);
+  server.on("/status.bin", handleStatusBinary);
   server.on("/reset-pulses", handleResetPulses);
+  server.on("/program/upload", handleProgramUpload);
+  server.on("/program/list", handleProgramList);
+  server.on("/program/run", handleProgramRun);
+  server.on("/program/cancel", handleProgramCancel);
   
   // Start web server
   server.begin();